@@ -0,0 +1,112 @@
+//! Per-call overhead on small messages.
+//!
+//! Compares, for JSON-like messages of a few sizes:
+//! - `fresh`:  a new Compressor, CCtx and DCtx for every message
+//! - `reused`: one Compressor, CCtx and DCtx, writing into reused buffers
+//! - `oneshot`: `compress_serial` / `decompress_serial` (thread-local pool)
+//!
+//! Run with `cargo bench --bench small_messages`.
+
+use rust_openzl::{compress_serial, decompress_serial, CCtx, Compressor, DCtx, ZstdGraph};
+use std::hint::black_box;
+use std::time::{Duration, Instant};
+
+const SIZES: [usize; 4] = [128, 1024, 4096, 8192];
+const MIN_TIME: Duration = Duration::from_millis(300);
+
+/// Distinct JSON-like records, concatenated up to `size` bytes
+fn make_messages(size: usize, count: usize) -> Vec<Vec<u8>> {
+    (0..count)
+        .map(|m| {
+            let mut msg = Vec::with_capacity(size + 128);
+            let mut i = m * 1000;
+            while msg.len() < size {
+                msg.extend_from_slice(
+                    format!(
+                        "{{\"id\":{i},\"user\":\"user{}\",\"score\":{},\"active\":{}}}",
+                        i % 97,
+                        (i * 7919) % 10007,
+                        i % 3 == 0
+                    )
+                    .as_bytes(),
+                );
+                i += 1;
+            }
+            msg.truncate(size);
+            msg
+        })
+        .collect()
+}
+
+/// Runs `f` on every message, for at least MIN_TIME; returns ns per call
+fn measure(messages: &[Vec<u8>], mut f: impl FnMut(&[u8])) -> f64 {
+    for msg in messages {
+        f(msg); // warm-up
+    }
+    let mut calls = 0u64;
+    let start = Instant::now();
+    while start.elapsed() < MIN_TIME {
+        for msg in messages {
+            f(msg);
+        }
+        calls += messages.len() as u64;
+    }
+    start.elapsed().as_nanos() as f64 / calls as f64
+}
+
+fn report(size: usize, mode: &str, op: &str, ns: f64) {
+    let mbps = size as f64 / ns * 1e3;
+    println!("{size:>6} B  {mode:<8} {op:<10} {ns:>10.0} ns/call {mbps:>9.1} MB/s");
+}
+
+fn main() {
+    let compressor = Compressor::with_graph(&ZstdGraph).expect("build compressor");
+    let mut cctx = CCtx::new();
+    let mut dctx = DCtx::new();
+    let mut compressed = Vec::new();
+    let mut decompressed = Vec::new();
+
+    for size in SIZES {
+        let messages = make_messages(size, 64);
+        let frames: Vec<Vec<u8>> = messages
+            .iter()
+            .map(|m| compress_serial(m).expect("compress"))
+            .collect();
+
+        let ns = measure(&messages, |msg| {
+            let compressor = Compressor::with_graph(&ZstdGraph).unwrap();
+            let mut dst = Vec::new();
+            CCtx::new().compress_append(&compressor, msg, &mut dst).unwrap();
+            black_box(dst);
+        });
+        report(size, "fresh", "compress", ns);
+        let ns = measure(&messages, |msg| {
+            compressed.clear();
+            cctx.compress_append(&compressor, msg, &mut compressed).unwrap();
+            black_box(&compressed);
+        });
+        report(size, "reused", "compress", ns);
+        let ns = measure(&messages, |msg| {
+            black_box(compress_serial(msg).unwrap());
+        });
+        report(size, "oneshot", "compress", ns);
+
+        let ns = measure(&frames, |frame| {
+            let mut dst = Vec::new();
+            DCtx::new().decompress_append(frame, &mut dst).unwrap();
+            black_box(dst);
+        });
+        report(size, "fresh", "decompress", ns);
+        let ns = measure(&frames, |frame| {
+            decompressed.clear();
+            dctx.decompress_append(frame, &mut decompressed).unwrap();
+            black_box(&decompressed);
+        });
+        report(size, "reused", "decompress", ns);
+        let ns = measure(&frames, |frame| {
+            black_box(decompress_serial(frame).unwrap());
+        });
+        report(size, "oneshot", "decompress", ns);
+        println!();
+    }
+}
@@ -79,11 +79,41 @@
 //!        ↓
 //! TypedRef compression (compress_typed_ref)
 //!        ↓
+//! Thread-local contexts (pool) / long-lived CCtx + DCtx
+//!        ↓
 //! CCtx + Compressor (graph registration)
 //!        ↓
 //! OpenZL C library (via rust-openzl-sys)
 //! ```
 //!
+//! ## Reusing Contexts
+//!
+//! Every `CCtx` / `DCtx` keeps its codec states and working memory between
+//! calls, and a `Compressor` only needs to be built once. For small messages,
+//! this setup dominates the cost of a call, so hot paths should keep them
+//! around and write into caller-provided buffers:
+//!
+//! ```
+//! use rust_openzl::{CCtx, Compressor, DCtx, ZstdGraph};
+//!
+//! let compressor = Compressor::with_graph(&ZstdGraph)?;
+//! let mut cctx = CCtx::new();
+//! let mut dctx = DCtx::new();
+//! let (mut compressed, mut decompressed) = (Vec::new(), Vec::new());
+//! for message in [&b"first message"[..], b"second message"] {
+//!     compressed.clear();
+//!     cctx.compress_append(&compressor, message, &mut compressed)?;
+//!     decompressed.clear();
+//!     dctx.decompress_append(&compressed, &mut decompressed)?;
+//!     assert_eq!(message, decompressed.as_slice());
+//! }
+//! # Ok::<(), rust_openzl::Error>(())
+//! ```
+//!
+//! The one-shot functions (`compress_serial`, `decompress_serial`, ...) use
+//! per-thread contexts from the [`pool`] module, so they avoid most of this
+//! setup too.
+//!
 //! ## Examples
 //!
 //! See the `examples/` directory for complete examples:
@@ -125,6 +155,10 @@ pub enum Error {
     },
 }
 
+/// Format version of the frames written by this crate: the newest one
+/// supported by the vendored library
+const FORMAT_VERSION: i32 = sys::ZL_MAX_FORMAT_VERSION as i32;
+
 // ============================================================================
 // Helper functions
 // ============================================================================
@@ -147,6 +181,119 @@ fn report_to_error(r: sys::ZL_Report) -> Error {
     }
 }
 
+/// Convert a ZL_Report of a CCtx operation to a Rust Error, with its context
+fn cctx_error(cctx: *const sys::ZL_CCtx, r: sys::ZL_Report) -> Error {
+    let code = sys::report_code(r);
+    let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
+        .to_string_lossy()
+        .into_owned();
+    let ctx = unsafe { CStr::from_ptr(sys::openzl_cctx_error_context(cctx, r)) };
+    error_from_report_with_ctx(code, name, Some(ctx))
+}
+
+/// Convert a ZL_Report of a DCtx operation to a Rust Error, with its context
+fn dctx_error(dctx: *const sys::ZL_DCtx, r: sys::ZL_Report) -> Error {
+    let code = sys::report_code(r);
+    let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
+        .to_string_lossy()
+        .into_owned();
+    let ctx = unsafe { CStr::from_ptr(sys::openzl_dctx_error_context(dctx, r)) };
+    error_from_report_with_ctx(code, name, Some(ctx))
+}
+
+mod sealed {
+    pub trait Sealed {}
+}
+
+/// Element types of numeric data: u8, u16, u32, u64, i8, i16, i32, i64, f32, f64.
+///
+/// Any bit pattern of the right width is a valid value of these types, so
+/// decompressed bytes can be written straight into them. This trait is
+/// sealed: it can't be implemented outside of this crate.
+pub trait Numeric: Copy + sealed::Sealed {}
+
+macro_rules! impl_numeric {
+    ($($t:ty),*) => {
+        $(
+            impl sealed::Sealed for $t {}
+            impl Numeric for $t {}
+        )*
+    };
+}
+
+impl_numeric!(u8, u16, u32, u64, i8, i16, i32, i64, f32, f64);
+
+/// Error for a frame which doesn't hold numeric values of `width` bytes
+fn check_numeric_output(data_type: sys::ZL_Type, elt_width: usize, width: usize) -> Result<(), Error> {
+    if data_type != sys::ZL_Type::ZL_Type_numeric {
+        return Err(Error::Report {
+            code: -1,
+            name: "Type mismatch".into(),
+            context: format!("\nExpected numeric type, got {:?}", data_type),
+        });
+    }
+    if elt_width != width {
+        return Err(Error::Report {
+            code: -1,
+            name: "Width mismatch".into(),
+            context: format!("\nExpected element width {}, got {}", width, elt_width),
+        });
+    }
+    Ok(())
+}
+
+/// Checks, from its header only, that frame `compressed` has a single
+/// numeric output which fits `capacity` elements of `width` bytes.
+///
+/// The header doesn't record the element width of numeric outputs: it is
+/// checked after decompression.
+fn check_numeric_frame(compressed: &[u8], width: usize, capacity: usize) -> Result<(), Error> {
+    let fi = unsafe { sys::ZL_FrameInfo_create(compressed.as_ptr() as *const _, compressed.len()) };
+    if fi.is_null() {
+        return Err(Error::Report {
+            code: -1,
+            name: "Invalid frame".into(),
+            context: "\nUnable to read the frame header".into(),
+        });
+    }
+    let (r_outputs, r_type, r_size) = unsafe {
+        (
+            sys::ZL_FrameInfo_getNumOutputs(fi),
+            sys::ZL_FrameInfo_getOutputType(fi, 0),
+            sys::ZL_FrameInfo_getDecompressedSize(fi, 0),
+        )
+    };
+    unsafe { sys::ZL_FrameInfo_free(fi) };
+    for r in [r_outputs, r_type, r_size] {
+        if sys::report_is_error(r) {
+            return Err(report_to_error(r));
+        }
+    }
+    let (nb_outputs, size) = (sys::report_value(r_outputs), sys::report_value(r_size));
+    if nb_outputs != 1 || sys::report_value(r_type) != sys::ZL_Type::ZL_Type_numeric as usize {
+        return Err(Error::Report {
+            code: -1,
+            name: "Type mismatch".into(),
+            context: format!(
+                "\nExpected a single numeric output, got {} output(s) of type {}",
+                nb_outputs,
+                sys::report_value(r_type)
+            ),
+        });
+    }
+    if size % width != 0 || size / width > capacity {
+        return Err(Error::Report {
+            code: -1,
+            name: "Size mismatch".into(),
+            context: format!(
+                "\nOutput of {} bytes doesn't fit {} elements of width {}",
+                size, capacity, width
+            ),
+        });
+    }
+    Ok(())
+}
+
 /// OpenZL warning (non-fatal issue during compression/decompression)
 #[derive(Debug, Clone)]
 pub struct Warning {
@@ -164,13 +311,13 @@ impl GraphId {
         unsafe { sys::ZL_GraphID_isValid(self.0) != 0 }
     }
 
-    #[allow(dead_code)] // Used for custom graph registration (Step 12)
-    pub(crate) fn as_raw(&self) -> sys::ZL_GraphID {
+    /// The raw `ZL_GraphID`, for graph construction through `rust_openzl_sys`
+    pub fn as_raw(&self) -> sys::ZL_GraphID {
         self.0
     }
 
-    #[allow(dead_code)] // Used for custom graph registration (Step 12)
-    pub(crate) fn from_raw(id: sys::ZL_GraphID) -> Self {
+    /// Wrap a `ZL_GraphID` registered through `rust_openzl_sys`
+    pub fn from_raw(id: sys::ZL_GraphID) -> Self {
         GraphId(id)
     }
 }
@@ -217,6 +364,9 @@ pub mod graphs {
 
     /// Constant value compression
     pub const CONSTANT: GraphId = make_graph_id(sys::ZL_StandardGraphID::ZL_StandardGraphID_constant as u32);
+
+    /// Default compression for the input's type (what `compress_serial` uses)
+    pub const COMPRESS_GENERIC: GraphId = make_graph_id(sys::ZL_StandardGraphID::ZL_StandardGraphID_compress_generic as u32);
 }
 
 /// Compression graph builder and manager
@@ -250,6 +400,129 @@ impl Compressor {
         Ok(())
     }
 
+    /// Create a Compressor starting with the graph built by `graph`.
+    ///
+    /// The Compressor can then compress any number of inputs, from any
+    /// number of `CCtx`.
+    pub fn with_graph<G: GraphFn + ?Sized>(graph: &G) -> Result<Self, Error> {
+        let mut compressor = Compressor::new();
+        compressor.set_parameter(sys::ZL_CParam::ZL_CParam_formatVersion, FORMAT_VERSION)?;
+        let graph_id = graph.build_graph(&mut compressor);
+        compressor.select_starting_graph(graph_id)?;
+        Ok(compressor)
+    }
+
+    /// Load a serialized Compressor, such as trained by `zli train`.
+    ///
+    /// Only serialized compressors made of standard components can be loaded:
+    /// custom codecs and graph functions are not registered here.
+    pub fn deserialize(serialized: &[u8]) -> Result<Self, Error> {
+        let mut compressor = Compressor::new();
+        let deserializer = unsafe { sys::ZL_CompressorDeserializer_create() };
+        assert!(!deserializer.is_null(), "ZL_CompressorDeserializer_create returned null");
+        let r = unsafe {
+            sys::ZL_CompressorDeserializer_deserialize(
+                deserializer,
+                compressor.as_mut_ptr(),
+                serialized.as_ptr() as *const _,
+                serialized.len(),
+            )
+        };
+        unsafe { sys::ZL_CompressorDeserializer_free(deserializer) };
+        if sys::report_is_error(r) {
+            return Err(report_to_error(r));
+        }
+        Ok(compressor)
+    }
+
+    /// Serialize this Compressor, to be loaded by [`Compressor::deserialize`]
+    /// or compiled by [`Compressor::compile`].
+    pub fn serialize(&self) -> Result<Vec<u8>, Error> {
+        let serializer = unsafe { sys::ZL_CompressorSerializer_create() };
+        assert!(!serializer.is_null(), "ZL_CompressorSerializer_create returned null");
+        let mut dst: *mut std::ffi::c_void = std::ptr::null_mut();
+        let mut dst_size = 0usize;
+        let r = unsafe {
+            sys::ZL_CompressorSerializer_serialize(serializer, self.0, &mut dst, &mut dst_size)
+        };
+        let result = if sys::report_is_error(r) {
+            Err(report_to_error(r))
+        } else {
+            // SAFETY: the output is owned by the serializer, freed below
+            Ok(unsafe { std::slice::from_raw_parts(dst as *const u8, dst_size) }.to_vec())
+        };
+        unsafe { sys::ZL_CompressorSerializer_free(serializer) };
+        result
+    }
+
+    /// Compile a serialized Compressor into a form that loads much faster.
+    ///
+    /// The result is a flat list of the registrations `deserialize` would
+    /// perform, which `load_compiled` replays without decoding or resolving
+    /// anything. Compile once (e.g. right after `zli train`) and ship the
+    /// compiled bytes alongside, or instead of, the serialized Compressor.
+    /// They can only be loaded by the same OpenZL version.
+    pub fn compile(serialized: &[u8]) -> Result<Vec<u8>, Error> {
+        let mut compressor = Compressor::new();
+        let deserializer = unsafe { sys::ZL_CompressorDeserializer_create() };
+        assert!(!deserializer.is_null(), "ZL_CompressorDeserializer_create returned null");
+        let mut dst: *mut std::ffi::c_void = std::ptr::null_mut();
+        let mut dst_size = 0usize;
+        let r = unsafe {
+            sys::ZL_CompressorDeserializer_compile(
+                deserializer,
+                compressor.as_mut_ptr(),
+                serialized.as_ptr() as *const _,
+                serialized.len(),
+                &mut dst,
+                &mut dst_size,
+            )
+        };
+        let result = if sys::report_is_error(r) {
+            Err(report_to_error(r))
+        } else {
+            // SAFETY: the output is owned by the deserializer, freed below
+            Ok(unsafe { std::slice::from_raw_parts(dst as *const u8, dst_size) }.to_vec())
+        };
+        unsafe { sys::ZL_CompressorDeserializer_free(deserializer) };
+        result
+    }
+
+    /// Load a Compressor compiled by [`Compressor::compile`].
+    ///
+    /// `compiled` is only read during the call, so it may be a memory mapped
+    /// file, at any alignment.
+    pub fn load_compiled(compiled: &[u8]) -> Result<Self, Error> {
+        let mut compressor = Compressor::new();
+        let r = unsafe {
+            sys::ZL_Compressor_loadCompiled(
+                compressor.as_mut_ptr(),
+                compiled.as_ptr() as *const _,
+                compiled.len(),
+            )
+        };
+        if sys::report_is_error(r) {
+            return Err(compressor.error(r));
+        }
+        Ok(compressor)
+    }
+
+    /// Select the graph compression starts with.
+    ///
+    /// This also validates the graphs registered so far.
+    pub fn select_starting_graph(&mut self, graph: GraphId) -> Result<(), Error> {
+        let r = unsafe { sys::ZL_Compressor_selectStartingGraphID(self.0, graph.0) };
+        if sys::report_is_error(r) {
+            return Err(report_to_error(r));
+        }
+        Ok(())
+    }
+
+    /// Register a ZSTD graph with its own compression level
+    pub fn register_zstd_graph_with_level(&mut self, level: i32) -> GraphId {
+        GraphId(unsafe { sys::ZL_Compressor_registerZstdGraph_withLevel(self.0, level) })
+    }
+
     /// Get warnings generated during graph construction/validation
     pub fn warnings(&self) -> Vec<Warning> {
         let arr = unsafe { sys::ZL_Compressor_getWarnings(self.0) };
@@ -266,11 +539,23 @@ impl Compressor {
             .collect()
     }
 
+    /// Convert a ZL_Report of an operation on this Compressor, with its context
+    fn error(&self, r: sys::ZL_Report) -> Error {
+        let code = sys::report_code(r);
+        let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
+            .to_string_lossy()
+            .into_owned();
+        let ctx = unsafe { CStr::from_ptr(sys::ZL_Compressor_getErrorContextString(self.0, r)) };
+        error_from_report_with_ctx(code, name, Some(ctx))
+    }
+
     pub(crate) fn as_ptr(&self) -> *const sys::ZL_Compressor {
         self.0 as *const _
     }
 
-    pub(crate) fn as_mut_ptr(&mut self) -> *mut sys::ZL_Compressor {
+    /// The raw `ZL_Compressor*`, to register custom graphs through
+    /// `rust_openzl_sys`. The Compressor keeps ownership.
+    pub fn as_mut_ptr(&mut self) -> *mut sys::ZL_Compressor {
         self.0
     }
 }
@@ -287,6 +572,87 @@ impl Default for Compressor {
     }
 }
 
+/// An immutable Compressor, shared by reference counting.
+///
+/// Cloning a snapshot only increments a counter, and snapshots can be sent
+/// to and used from any number of threads at once: load a Compressor once
+/// per process and hand a clone to each worker. It dereferences to a
+/// `&Compressor`, usable with every `CCtx::compress_*` method.
+///
+/// ```
+/// use rust_openzl::{CCtx, Compressor, CompressorSnapshot, ZstdGraph};
+///
+/// let snapshot = CompressorSnapshot::new(Compressor::with_graph(&ZstdGraph)?)?;
+/// let workers: Vec<_> = (0..4)
+///     .map(|i| {
+///         let snapshot = snapshot.clone();
+///         std::thread::spawn(move || {
+///             let mut compressed = Vec::new();
+///             let message = format!("message {i}").repeat(10);
+///             CCtx::new().compress_append(&snapshot, message.as_bytes(), &mut compressed)
+///         })
+///     })
+///     .collect();
+/// for worker in workers {
+///     worker.join().unwrap()?;
+/// }
+/// # Ok::<(), rust_openzl::Error>(())
+/// ```
+pub struct CompressorSnapshot {
+    ptr: *mut sys::ZL_CompressorSnapshot,
+    // Borrowed view of the snapshot's compressor, never dropped directly
+    compressor: std::mem::ManuallyDrop<Compressor>,
+}
+
+// The compressor is never modified once snapshotted, and the reference count
+// is atomic
+unsafe impl Send for CompressorSnapshot {}
+unsafe impl Sync for CompressorSnapshot {}
+
+impl CompressorSnapshot {
+    /// Freeze `compressor`, which must have a starting graph.
+    pub fn new(compressor: Compressor) -> Result<Self, Error> {
+        let ptr = unsafe { sys::ZL_CompressorSnapshot_create(compressor.0) };
+        if ptr.is_null() {
+            return Err(Error::Report {
+                code: -1,
+                name: "Invalid compressor".into(),
+                context: "\nA snapshot requires a Compressor with a starting graph".into(),
+            });
+        }
+        // The snapshot owns the compressor from now on
+        let compressor = std::mem::ManuallyDrop::new(compressor);
+        Ok(CompressorSnapshot { ptr, compressor })
+    }
+
+    /// Load a compiled Compressor (see [`Compressor::compile`]) as a snapshot.
+    pub fn load_compiled(compiled: &[u8]) -> Result<Self, Error> {
+        Self::new(Compressor::load_compiled(compiled)?)
+    }
+}
+
+impl std::ops::Deref for CompressorSnapshot {
+    type Target = Compressor;
+
+    fn deref(&self) -> &Compressor {
+        &self.compressor
+    }
+}
+
+impl Clone for CompressorSnapshot {
+    fn clone(&self) -> Self {
+        let ptr = unsafe { sys::ZL_CompressorSnapshot_ref(self.ptr) };
+        let compressor = std::mem::ManuallyDrop::new(Compressor(self.compressor.0));
+        CompressorSnapshot { ptr, compressor }
+    }
+}
+
+impl Drop for CompressorSnapshot {
+    fn drop(&mut self) {
+        unsafe { sys::ZL_CompressorSnapshot_free(self.ptr) }
+    }
+}
+
 // ============================================================================
 // Graph Function API
 // ============================================================================
@@ -338,90 +704,38 @@ impl GraphFn for FieldLzGraph {
     }
 }
 
-// Placeholder trampoline for custom graph functions (used in Step 12)
-#[allow(dead_code)]
-unsafe extern "C" fn graph_fn_trampoline(_compressor: *mut sys::ZL_Compressor) -> sys::ZL_GraphID {
-    // This is a placeholder for custom graph registration (Step 12).
-    // For now, standard graphs use dedicated callbacks below.
-    // Custom graphs will require thread-local storage or user data passing.
-    graphs::ZSTD.0
-}
-
-/// Compress data using a graph function.
-///
-/// This is a stateless compression function that uses the provided GraphFn
-/// to define the compression strategy.
-pub fn compress_with_graph<G: GraphFn>(src: &[u8], graph: &G) -> Result<Vec<u8>, Error> {
-    // Allocate output buffer (use compress_bound to estimate size)
-    let max_size = compress_bound(src.len());
-    let mut dst = vec![0u8; max_size];
-
-    // Create a temporary compressor to get the GraphID
-    let mut compressor = Compressor::new();
-    let graph_id = graph.build_graph(&mut compressor);
-
-    // Use ZL_compress_usingGraphFn with a C callback that selects the graph
-    // The callback will also set required parameters like format version
-    let graph_fn = make_graph_selector_fn(graph_id);
-
-    let r = unsafe {
-        sys::ZL_compress_usingGraphFn(
-            dst.as_mut_ptr() as *mut _,
-            dst.len(),
-            src.as_ptr() as *const _,
-            src.len(),
-            graph_fn,
-        )
-    };
-
-    if sys::report_is_error(r) {
-        return Err(report_to_error(r));
+/// A GraphId is its own graph: use it for standard graphs, e.g. `graphs::FSE`.
+impl GraphFn for GraphId {
+    fn build_graph(&self, _compressor: &mut Compressor) -> GraphId {
+        *self
     }
-
-    let compressed_size = sys::report_value(r);
-    dst.truncate(compressed_size);
-    Ok(dst)
 }
 
-// Helper to create a C callback that selects a specific GraphID
-fn make_graph_selector_fn(graph_id: GraphId) -> sys::ZL_GraphFn {
-    // For standard graphs, we can use dedicated callbacks
-    match graph_id.0.gid {
-        id if id == graphs::ZSTD.0.gid => Some(zstd_graph_callback),
-        id if id == graphs::NUMERIC.0.gid => Some(numeric_graph_callback),
-        id if id == graphs::STORE.0.gid => Some(store_graph_callback),
-        id if id == graphs::FIELD_LZ.0.gid => Some(field_lz_graph_callback),
-        _ => {
-            // For custom graphs, we'd need a different mechanism
-            // For now, fall back to ZSTD
-            Some(zstd_graph_callback)
-        }
+/// Closures registering custom graphs, e.g.
+/// `|c: &mut Compressor| c.register_zstd_graph_with_level(19)`
+impl<F: Fn(&mut Compressor) -> GraphId> GraphFn for F {
+    fn build_graph(&self, compressor: &mut Compressor) -> GraphId {
+        self(compressor)
     }
 }
 
-// Dedicated C callbacks for standard graphs
-unsafe extern "C" fn zstd_graph_callback(compressor: *mut sys::ZL_Compressor) -> sys::ZL_GraphID {
-    // Set format version (required by OpenZL)
-    sys::ZL_Compressor_setParameter(compressor, sys::ZL_CParam::ZL_CParam_formatVersion, 21);
-    graphs::ZSTD.0
-}
-
-unsafe extern "C" fn numeric_graph_callback(compressor: *mut sys::ZL_Compressor) -> sys::ZL_GraphID {
-    // Set format version (required by OpenZL)
-    sys::ZL_Compressor_setParameter(compressor, sys::ZL_CParam::ZL_CParam_formatVersion, 21);
-    graphs::NUMERIC.0
-}
-
-unsafe extern "C" fn store_graph_callback(compressor: *mut sys::ZL_Compressor) -> sys::ZL_GraphID {
-    // Set format version (required by OpenZL)
-    sys::ZL_Compressor_setParameter(compressor, sys::ZL_CParam::ZL_CParam_formatVersion, 21);
-    graphs::STORE.0
+/// Compress data using a graph function.
+///
+/// The graph is built into a new Compressor on every call: to compress many
+/// inputs, build the Compressor once with [`Compressor::with_graph`] and use
+/// [`compress_with_compressor`] or a long-lived [`CCtx`].
+pub fn compress_with_graph<G: GraphFn>(src: &[u8], graph: &G) -> Result<Vec<u8>, Error> {
+    let compressor = Compressor::with_graph(graph)?;
+    compress_with_compressor(src, &compressor)
 }
 
-unsafe extern "C" fn field_lz_graph_callback(compressor: *mut sys::ZL_Compressor) -> sys::ZL_GraphID {
-    // Set format version (required by OpenZL)
-    sys::ZL_Compressor_setParameter(compressor, sys::ZL_CParam::ZL_CParam_formatVersion, 21);
-    graphs::FIELD_LZ.0
+/// Compress data with a Compressor, e.g. a deserialized one.
+pub fn compress_with_compressor(src: &[u8], compressor: &Compressor) -> Result<Vec<u8>, Error> {
+    pool::with_cctx(|cctx| {
+        let mut dst = Vec::new();
+        cctx.compress_append(compressor, src, &mut dst)?;
+        Ok(dst)
+    })
 }
 
 // ============================================================================
@@ -435,6 +749,7 @@ unsafe extern "C" fn field_lz_graph_callback(compressor: *mut sys::ZL_Compressor
 /// that uses it.
 pub struct TypedRef<'a> {
     ptr: *mut sys::ZL_TypedRef,
+    byte_size: usize,
     _marker: std::marker::PhantomData<&'a [u8]>,
 }
 
@@ -447,22 +762,14 @@ impl<'a> TypedRef<'a> {
         assert!(!ptr.is_null(), "ZL_TypedRef_createSerial returned null");
         TypedRef {
             ptr,
+            byte_size: data.len(),
             _marker: std::marker::PhantomData,
         }
     }
 
-    /// Create a TypedRef for numeric data.
-    ///
-    /// T must have size 1, 2, 4, or 8 bytes (u8, u16, u32, u64, i8, i16, i32, i64, f32, f64)
-    pub fn numeric<T: Copy>(data: &'a [T]) -> Result<Self, Error> {
+    /// Create a TypedRef for numeric data (see [`Numeric`] for supported types)
+    pub fn numeric<T: Numeric>(data: &'a [T]) -> Result<Self, Error> {
         let width = std::mem::size_of::<T>();
-        if !matches!(width, 1 | 2 | 4 | 8) {
-            return Err(Error::Report {
-                code: -1,
-                name: "Invalid numeric type".into(),
-                context: format!("\nElement size must be 1, 2, 4, or 8 bytes, got {width}"),
-            });
-        }
         let ptr = unsafe {
             sys::ZL_TypedRef_createNumeric(
                 data.as_ptr() as *const _,
@@ -473,6 +780,7 @@ impl<'a> TypedRef<'a> {
         assert!(!ptr.is_null(), "ZL_TypedRef_createNumeric returned null");
         Ok(TypedRef {
             ptr,
+            byte_size: std::mem::size_of_val(data),
             _marker: std::marker::PhantomData,
         })
     }
@@ -493,6 +801,7 @@ impl<'a> TypedRef<'a> {
         assert!(!ptr.is_null(), "ZL_TypedRef_createString returned null");
         TypedRef {
             ptr,
+            byte_size: flat.len() + std::mem::size_of_val(lens),
             _marker: std::marker::PhantomData,
         }
     }
@@ -527,10 +836,16 @@ impl<'a> TypedRef<'a> {
         assert!(!ptr.is_null(), "ZL_TypedRef_createStruct returned null");
         Ok(TypedRef {
             ptr,
+            byte_size: bytes.len(),
             _marker: std::marker::PhantomData,
         })
     }
 
+    /// Size of the referenced data in bytes, including string lengths
+    pub fn byte_size(&self) -> usize {
+        self.byte_size
+    }
+
     pub(crate) fn as_ptr(&self) -> *const sys::ZL_TypedRef {
         self.ptr as *const _
     }
@@ -594,7 +909,7 @@ impl TypedBuffer {
     /// - The data type is not numeric
     /// - The element width doesn't match T's size
     /// - The buffer is not properly aligned for T
-    pub fn as_numeric<T: Copy>(&self) -> Option<&[T]> {
+    pub fn as_numeric<T: Numeric>(&self) -> Option<&[T]> {
         // Check if type is numeric
         if self.data_type() != sys::ZL_Type::ZL_Type_numeric {
             return None;
@@ -669,22 +984,32 @@ fn error_from_report_with_ctx(code: i32, name: String, ctx_str: Option<&CStr>) -
     Error::Report { code, name, context }
 }
 
+/// Compression context.
+///
+/// A CCtx keeps its working memory between calls: keep one around (or use
+/// [`pool::with_cctx`]) to compress many inputs. The `compress_*` methods
+/// taking a `&Compressor` only reference it for the duration of the call,
+/// so one Compressor can be shared by any number of contexts.
 pub struct CCtx(*mut sys::ZL_CCtx);
+
+// The CCtx is exclusively owned, and only used through `&mut self`
+unsafe impl Send for CCtx {}
+
 impl CCtx {
     pub fn new() -> Self {
         let ptr = unsafe { sys::ZL_CCtx_create() };
         assert!(!ptr.is_null(), "ZL_CCtx_create returned null");
         CCtx(ptr)
     }
+    /// Set a parameter for the next compression.
+    ///
+    /// Parameters are reset after each compression, even when
+    /// `ZL_CParam_stickyParameters` is set, so that the CCtx never outlives
+    /// its reference to a Compressor.
     pub fn set_parameter(&mut self, p: sys::ZL_CParam, v: i32) -> Result<(), Error> {
         let r = unsafe { sys::ZL_CCtx_setParameter(self.0, p, v) };
         if sys::report_is_error(r) {
-            let code = sys::report_code(r);
-            let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
-                .to_string_lossy()
-                .into_owned();
-            let ctx = unsafe { CStr::from_ptr(sys::openzl_cctx_error_context(self.0, r)) };
-            return Err(error_from_report_with_ctx(code, name, Some(&ctx)));
+            return Err(cctx_error(self.0, r));
         }
         Ok(())
     }
@@ -694,17 +1019,28 @@ impl CCtx {
     /// This enables TypedRef compression by associating the CCtx with a Compressor
     /// that has registered compression graphs.
     ///
-    /// IMPORTANT: The Compressor must remain valid for the duration of its usage.
+    /// The reference only lasts until the end of the next compression
+    /// ([`CCtx::compress_typed_ref`] or [`CCtx::compress_multi_typed_ref`]).
+    ///
+    /// IMPORTANT: The Compressor must remain valid until that compression.
     /// The Compressor must be validated before being referenced.
     pub fn ref_compressor(&mut self, compressor: &Compressor) -> Result<(), Error> {
         let r = unsafe { sys::ZL_CCtx_refCompressor(self.0, compressor.as_ptr()) };
         if sys::report_is_error(r) {
-            let code = sys::report_code(r);
-            let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
-                .to_string_lossy()
-                .into_owned();
-            let ctx = unsafe { CStr::from_ptr(sys::openzl_cctx_error_context(self.0, r)) };
-            return Err(error_from_report_with_ctx(code, name, Some(&ctx)));
+            return Err(cctx_error(self.0, r));
+        }
+        Ok(())
+    }
+
+    /// Reference a snapshot for the next typed compression, like
+    /// [`CCtx::ref_compressor`].
+    ///
+    /// The CCtx also holds a reference to the snapshot until the end of that
+    /// compression, so `snapshot` may be dropped in the meantime.
+    pub fn ref_snapshot(&mut self, snapshot: &CompressorSnapshot) -> Result<(), Error> {
+        let r = unsafe { sys::ZL_CCtx_refCompressorSnapshot(self.0, snapshot.ptr) };
+        if sys::report_is_error(r) {
+            return Err(cctx_error(self.0, r));
         }
         Ok(())
     }
@@ -725,7 +1061,56 @@ impl CCtx {
             .collect()
     }
 
-    /// Compress a single typed input
+    /// Compress `src` with `compressor` into `dst`.
+    ///
+    /// Returns the compressed size. `dst` should hold at least
+    /// `compress_bound(src.len())` bytes to never fail for lack of room.
+    pub fn compress_into(&mut self, compressor: &Compressor, src: &[u8], dst: &mut [u8]) -> Result<usize, Error> {
+        let (dst_ptr, dst_cap) = (dst.as_mut_ptr(), dst.len());
+        self.compress_with(compressor, |cctx| unsafe {
+            sys::ZL_CCtx_compress(cctx, dst_ptr as *mut _, dst_cap, src.as_ptr() as *const _, src.len())
+        })
+    }
+
+    /// Compress `src` with `compressor`, appending the frame to `dst`.
+    ///
+    /// `dst` only grows when its spare capacity can't hold the worst case,
+    /// so a cleared Vec is reused without reallocation. Returns the
+    /// compressed size.
+    pub fn compress_append(&mut self, compressor: &Compressor, src: &[u8], dst: &mut Vec<u8>) -> Result<usize, Error> {
+        dst.reserve(compress_bound(src.len()));
+        let spare = dst.spare_capacity_mut();
+        let (dst_ptr, dst_cap) = (spare.as_mut_ptr(), spare.len());
+        let n = self.compress_with(compressor, |cctx| unsafe {
+            sys::ZL_CCtx_compress(cctx, dst_ptr as *mut _, dst_cap, src.as_ptr() as *const _, src.len())
+        })?;
+        // SAFETY: the first `n` spare bytes were written by the compressor
+        unsafe { dst.set_len(dst.len() + n) };
+        Ok(n)
+    }
+
+    /// Compress a typed input with `compressor` into `dst`.
+    ///
+    /// Returns the compressed size. Size `dst` with
+    /// `compress_bound(input.byte_size())`.
+    pub fn compress_typed_into(&mut self, compressor: &Compressor, input: &TypedRef, dst: &mut [u8]) -> Result<usize, Error> {
+        let (dst_ptr, dst_cap) = (dst.as_mut_ptr(), dst.len());
+        self.compress_with(compressor, |cctx| unsafe {
+            sys::ZL_CCtx_compressTypedRef(cctx, dst_ptr as *mut _, dst_cap, input.as_ptr())
+        })
+    }
+
+    /// Compress multiple typed inputs with `compressor` into a single frame
+    pub fn compress_multi_typed_into(&mut self, compressor: &Compressor, inputs: &[&TypedRef], dst: &mut [u8]) -> Result<usize, Error> {
+        let mut ptrs: Vec<*const sys::ZL_TypedRef> = inputs.iter().map(|tr| tr.as_ptr()).collect();
+        let (dst_ptr, dst_cap) = (dst.as_mut_ptr(), dst.len());
+        self.compress_with(compressor, |cctx| unsafe {
+            sys::ZL_CCtx_compressMultiTypedRef(cctx, dst_ptr as *mut _, dst_cap, ptrs.as_mut_ptr() as *mut _, ptrs.len())
+        })
+    }
+
+    /// Compress a single typed input, with the Compressor set by
+    /// [`CCtx::ref_compressor`]
     pub fn compress_typed_ref(&mut self, input: &TypedRef, dst: &mut [u8]) -> Result<usize, Error> {
         let r = unsafe {
             sys::ZL_CCtx_compressTypedRef(
@@ -735,18 +1120,11 @@ impl CCtx {
                 input.as_ptr(),
             )
         };
-        if sys::report_is_error(r) {
-            let code = sys::report_code(r);
-            let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
-                .to_string_lossy()
-                .into_owned();
-            let ctx = unsafe { CStr::from_ptr(sys::openzl_cctx_error_context(self.0, r)) };
-            return Err(error_from_report_with_ctx(code, name, Some(&ctx)));
-        }
-        Ok(sys::report_value(r))
+        self.end_compression(r)
     }
 
-    /// Compress multiple typed inputs into a single frame
+    /// Compress multiple typed inputs into a single frame, with the
+    /// Compressor set by [`CCtx::ref_compressor`]
     pub fn compress_multi_typed_ref(&mut self, inputs: &[&TypedRef], dst: &mut [u8]) -> Result<usize, Error> {
         let mut ptrs: Vec<*const sys::ZL_TypedRef> = inputs.iter().map(|tr| tr.as_ptr()).collect();
         let r = unsafe {
@@ -758,20 +1136,73 @@ impl CCtx {
                 ptrs.len(),
             )
         };
-        if sys::report_is_error(r) {
-            let code = sys::report_code(r);
-            let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
-                .to_string_lossy()
-                .into_owned();
-            let ctx = unsafe { CStr::from_ptr(sys::openzl_cctx_error_context(self.0, r)) };
-            return Err(error_from_report_with_ctx(code, name, Some(&ctx)));
+        self.end_compression(r)
+    }
+
+    /// Run one compression with `compressor` referenced
+    fn compress_with<F>(&mut self, compressor: &Compressor, compress: F) -> Result<usize, Error>
+    where
+        F: FnOnce(*mut sys::ZL_CCtx) -> sys::ZL_Report,
+    {
+        let version = sys::ZL_CParam::ZL_CParam_formatVersion;
+        let mut r = unsafe { sys::ZL_CCtx_refCompressor(self.0, compressor.as_ptr()) };
+        // Deserialized Compressors may not set a format version
+        let needs_version = unsafe {
+            sys::ZL_CCtx_getParameter(self.0, version) == 0
+                && sys::ZL_Compressor_getParameter(compressor.as_ptr(), version) == 0
+        };
+        if !sys::report_is_error(r) && needs_version {
+            r = unsafe { sys::ZL_CCtx_setParameter(self.0, version, FORMAT_VERSION) };
         }
-        Ok(sys::report_value(r))
+        if !sys::report_is_error(r) {
+            r = compress(self.0);
+        }
+        self.end_compression(r)
+    }
+
+    /// Result of a compression, after resetting parameters.
+    ///
+    /// Parameters are normally dropped by a successful compression, but not
+    /// by a failed one, nor when they are sticky (`ZL_CParam_stickyParameters`
+    /// set on the CCtx or on the Compressor). Resetting them after every
+    /// compression ensures the CCtx never keeps a dangling Compressor.
+    fn end_compression(&mut self, r: sys::ZL_Report) -> Result<usize, Error> {
+        let result = if sys::report_is_error(r) {
+            Err(cctx_error(self.0, r))
+        } else {
+            Ok(sys::report_value(r))
+        };
+        unsafe { sys::ZL_CCtx_resetParameters(self.0) };
+        result
     }
 }
 impl Drop for CCtx { fn drop(&mut self) { unsafe { sys::ZL_CCtx_free(self.0) } } }
 
+impl Default for CCtx {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Type and size of an output decompressed by [`DCtx::decompress_typed_into`]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct OutputInfo {
+    pub data_type: sys::ZL_Type,
+    /// Width of each element in bytes (1 for serial data)
+    pub elt_width: usize,
+    pub byte_size: usize,
+    pub num_elts: usize,
+}
+
+/// Decompression context.
+///
+/// Like [`CCtx`], a DCtx keeps its working memory between calls, so a
+/// long-lived one decompresses small frames much faster than a new one.
 pub struct DCtx(*mut sys::ZL_DCtx);
+
+// The DCtx is exclusively owned, and only used through `&mut self`
+unsafe impl Send for DCtx {}
+
 impl DCtx {
     pub fn new() -> Self {
         let p = unsafe { sys::ZL_DCtx_create() };
@@ -795,6 +1226,105 @@ impl DCtx {
             .collect()
     }
 
+    /// Decompress a serial frame into `dst`, returning the decompressed size
+    pub fn decompress_into(&mut self, compressed: &[u8], dst: &mut [u8]) -> Result<usize, Error> {
+        let r = unsafe {
+            sys::ZL_DCtx_decompress(
+                self.0,
+                dst.as_mut_ptr() as *mut _,
+                dst.len(),
+                compressed.as_ptr() as *const _,
+                compressed.len(),
+            )
+        };
+        if sys::report_is_error(r) {
+            return Err(dctx_error(self.0, r));
+        }
+        Ok(sys::report_value(r))
+    }
+
+    /// Decompress a serial frame, appending its content to `dst`.
+    ///
+    /// Returns the decompressed size.
+    pub fn decompress_append(&mut self, compressed: &[u8], dst: &mut Vec<u8>) -> Result<usize, Error> {
+        let rsize = unsafe { sys::ZL_getDecompressedSize(compressed.as_ptr() as *const _, compressed.len()) };
+        if sys::report_is_error(rsize) {
+            return Err(report_to_error(rsize));
+        }
+        dst.reserve(sys::report_value(rsize));
+        let spare = dst.spare_capacity_mut();
+        let r = unsafe {
+            sys::ZL_DCtx_decompress(
+                self.0,
+                spare.as_mut_ptr() as *mut _,
+                spare.len(),
+                compressed.as_ptr() as *const _,
+                compressed.len(),
+            )
+        };
+        if sys::report_is_error(r) {
+            return Err(dctx_error(self.0, r));
+        }
+        let n = sys::report_value(r);
+        // SAFETY: the first `n` spare bytes were written by the decompressor
+        unsafe { dst.set_len(dst.len() + n) };
+        Ok(n)
+    }
+
+    /// Decompress a single-output typed frame into `dst`.
+    ///
+    /// Works for serial, numeric and struct outputs, but not strings.
+    /// Numeric values are written in host endianness, and `dst` must be
+    /// aligned for them (8 bytes if unknown): prefer
+    /// [`DCtx::decompress_numeric_into`] when the type is known.
+    pub fn decompress_typed_into(&mut self, compressed: &[u8], dst: &mut [u8]) -> Result<OutputInfo, Error> {
+        self.decompress_typed_raw(compressed, dst.as_mut_ptr(), dst.len())
+    }
+
+    /// Decompress a numeric frame straight into `dst`.
+    ///
+    /// Returns the number of elements written, after checking the frame
+    /// holds numeric values of `T`'s width.
+    pub fn decompress_numeric_into<T: Numeric>(&mut self, compressed: &[u8], dst: &mut [T]) -> Result<usize, Error> {
+        self.decompress_numeric_raw(compressed, dst.as_mut_ptr(), dst.len())
+    }
+
+    /// `decompress_numeric_into` for `capacity` elements at `dst`, which
+    /// may be uninitialized
+    fn decompress_numeric_raw<T: Numeric>(&mut self, compressed: &[u8], dst: *mut T, capacity: usize) -> Result<usize, Error> {
+        let width = std::mem::size_of::<T>();
+        // Reject non-numeric frames before writing anything into `dst`
+        check_numeric_frame(compressed, width, capacity)?;
+        let info = self.decompress_typed_raw(compressed, dst as *mut u8, capacity * width)?;
+        check_numeric_output(info.data_type, info.elt_width, width)?;
+        Ok(info.num_elts)
+    }
+
+    fn decompress_typed_raw(&mut self, compressed: &[u8], dst: *mut u8, capacity: usize) -> Result<OutputInfo, Error> {
+        let mut info = std::mem::MaybeUninit::<sys::ZL_OutputInfo>::uninit();
+        let r = unsafe {
+            sys::ZL_DCtx_decompressTyped(
+                self.0,
+                info.as_mut_ptr(),
+                dst as *mut _,
+                capacity,
+                compressed.as_ptr() as *const _,
+                compressed.len(),
+            )
+        };
+        if sys::report_is_error(r) {
+            return Err(dctx_error(self.0, r));
+        }
+        // SAFETY: filled on success
+        let info = unsafe { info.assume_init() };
+        Ok(OutputInfo {
+            data_type: info.type_,
+            elt_width: info.fixedWidth as usize,
+            byte_size: info.decompressedByteSize as usize,
+            num_elts: info.numElts as usize,
+        })
+    }
+
     /// Decompress into a TypedBuffer (auto-sized, single output)
     pub fn decompress_typed_buffer(&mut self, compressed: &[u8], output: &mut TypedBuffer) -> Result<usize, Error> {
         let r = unsafe {
@@ -806,12 +1336,7 @@ impl DCtx {
             )
         };
         if sys::report_is_error(r) {
-            let code = sys::report_code(r);
-            let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
-                .to_string_lossy()
-                .into_owned();
-            let ctx = unsafe { CStr::from_ptr(sys::openzl_dctx_error_context(self.0, r)) };
-            return Err(error_from_report_with_ctx(code, name, Some(&ctx)));
+            return Err(dctx_error(self.0, r));
         }
         Ok(sys::report_value(r))
     }
@@ -829,80 +1354,103 @@ impl DCtx {
             )
         };
         if sys::report_is_error(r) {
-            let code = sys::report_code(r);
-            let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
-                .to_string_lossy()
-                .into_owned();
-            let ctx = unsafe { CStr::from_ptr(sys::openzl_dctx_error_context(self.0, r)) };
-            return Err(error_from_report_with_ctx(code, name, Some(&ctx)));
+            return Err(dctx_error(self.0, r));
         }
         Ok(sys::report_value(r))
     }
 }
 impl Drop for DCtx { fn drop(&mut self) { unsafe { sys::ZL_DCtx_free(self.0) } } }
 
-pub fn compress_serial(src: &[u8]) -> Result<Vec<u8>, Error> {
-    let mut cctx = CCtx::new();
-    // Set format version (required by OpenZL). Use latest version (21).
-    cctx.set_parameter(sys::ZL_CParam::ZL_CParam_formatVersion, 21)?;
-    // Capacity upper bound
-    let cap = unsafe { sys::openzl_compress_bound(src.len()) };
-    let mut dst = vec![0u8; cap];
-    let r = unsafe {
-        sys::ZL_CCtx_compress(
-            cctx.0,
-            dst.as_mut_ptr() as *mut _,
-            dst.len(),
-            src.as_ptr() as *const _,
-            src.len(),
-        )
-    };
-    if sys::report_is_error(r) {
-        let code = sys::report_code(r);
-        let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
-            .to_string_lossy()
-            .into_owned();
-        let ctx = unsafe { CStr::from_ptr(sys::openzl_cctx_error_context(cctx.0, r)) };
-        return Err(error_from_report_with_ctx(code, name, Some(&ctx)));
+impl Default for DCtx {
+    fn default() -> Self {
+        Self::new()
     }
-    let n = sys::report_value(r) as usize;
-    dst.truncate(n);
-    Ok(dst)
 }
 
-/// Compress a single TypedRef and return the compressed bytes.
+// ============================================================================
+// Thread-local context pool
+// ============================================================================
+
+/// Per-thread contexts, used by the one-shot functions of this crate.
 ///
-/// This uses ZSTD graph by default. For better compression on specific data types,
-/// consider using type-specific compression functions or creating a custom Compressor
-/// with appropriate graphs.
-pub fn compress_typed_ref(input: &TypedRef) -> Result<Vec<u8>, Error> {
-    let mut cctx = CCtx::new();
-    // Set format version (required by OpenZL). Use latest version (21).
-    cctx.set_parameter(sys::ZL_CParam::ZL_CParam_formatVersion, 21)?;
+/// Creating a CCtx / DCtx and a Compressor costs more than compressing a
+/// small message, so each thread keeps one of each context, plus the
+/// Compressors of the standard graphs, alive for its whole lifetime.
+pub mod pool {
+    use super::{CCtx, Compressor, DCtx, Error, GraphId};
+    use std::cell::RefCell;
+    use std::rc::Rc;
+
+    thread_local! {
+        static CCTX: RefCell<Option<CCtx>> = RefCell::new(None);
+        static DCTX: RefCell<Option<DCtx>> = RefCell::new(None);
+        static COMPRESSORS: RefCell<Vec<(u32, Rc<Compressor>)>> = RefCell::new(Vec::new());
+    }
 
-    // Create a Compressor with ZSTD graph (reasonable default for general use)
-    let mut compressor = Compressor::new();
-    compressor.set_parameter(sys::ZL_CParam::ZL_CParam_formatVersion, 21)?;
+    /// Run `f` with this thread's CCtx.
+    ///
+    /// Nested calls (from within `f`) get a temporary CCtx instead.
+    pub fn with_cctx<R>(f: impl FnOnce(&mut CCtx) -> R) -> R {
+        CCTX.with(|cell| match cell.try_borrow_mut() {
+            Ok(mut slot) => f(slot.get_or_insert_with(CCtx::new)),
+            Err(_) => f(&mut CCtx::new()),
+        })
+    }
 
-    // Register ZSTD as the starting graph using the graph callback approach
-    let r = unsafe {
-        sys::ZL_Compressor_initUsingGraphFn(compressor.as_mut_ptr(), Some(zstd_graph_callback))
-    };
-    if sys::report_is_error(r) {
-        return Err(report_to_error(r));
+    /// Run `f` with this thread's DCtx.
+    ///
+    /// Nested calls (from within `f`) get a temporary DCtx instead.
+    pub fn with_dctx<R>(f: impl FnOnce(&mut DCtx) -> R) -> R {
+        DCTX.with(|cell| match cell.try_borrow_mut() {
+            Ok(mut slot) => f(slot.get_or_insert_with(DCtx::new)),
+            Err(_) => f(&mut DCtx::new()),
+        })
     }
 
-    // Reference the compressor in the CCtx
-    cctx.ref_compressor(&compressor)?;
+    /// Free this thread's contexts and cached Compressors.
+    ///
+    /// They are recreated on next use.
+    pub fn clear() {
+        CCTX.with(|cell| {
+            if let Ok(mut slot) = cell.try_borrow_mut() {
+                *slot = None;
+            }
+        });
+        DCTX.with(|cell| {
+            if let Ok(mut slot) = cell.try_borrow_mut() {
+                *slot = None;
+            }
+        });
+        COMPRESSORS.with(|cache| cache.borrow_mut().clear());
+    }
 
-    // Estimate capacity based on input data (this is conservative)
-    // For TypedRef we can't easily get the size, so use a large upper bound
-    let cap = 1024 * 1024; // 1MB default, adjust as needed
-    let mut dst = vec![0u8; cap];
+    /// This thread's Compressor starting with the standard graph `graph`
+    pub(crate) fn standard_compressor(graph: GraphId) -> Result<Rc<Compressor>, Error> {
+        let key = graph.as_raw().gid;
+        COMPRESSORS.with(|cache| {
+            if let Some((_, c)) = cache.borrow().iter().find(|(k, _)| *k == key) {
+                return Ok(Rc::clone(c));
+            }
+            let compressor = Rc::new(Compressor::with_graph(&graph)?);
+            cache.borrow_mut().push((key, Rc::clone(&compressor)));
+            Ok(compressor)
+        })
+    }
+}
 
-    let n = cctx.compress_typed_ref(input, &mut dst)?;
-    dst.truncate(n);
-    Ok(dst)
+pub fn compress_serial(src: &[u8]) -> Result<Vec<u8>, Error> {
+    let compressor = pool::standard_compressor(graphs::COMPRESS_GENERIC)?;
+    compress_with_compressor(src, &compressor)
+}
+
+/// Compress a single TypedRef and return the compressed bytes.
+///
+/// This uses ZSTD graph by default. For better compression on specific data types,
+/// consider using type-specific compression functions or creating a custom Compressor
+/// with appropriate graphs.
+pub fn compress_typed_ref(input: &TypedRef) -> Result<Vec<u8>, Error> {
+    let compressor = pool::standard_compressor(graphs::ZSTD)?;
+    compress_typed_with(&compressor, input)
 }
 
 /// Compress multiple TypedRefs into a single frame.
@@ -910,62 +1458,34 @@ pub fn compress_typed_ref(input: &TypedRef) -> Result<Vec<u8>, Error> {
 /// This uses ZSTD graph by default. For better compression on specific data types,
 /// consider creating a custom Compressor with appropriate graphs.
 pub fn compress_multi_typed_ref(inputs: &[&TypedRef]) -> Result<Vec<u8>, Error> {
-    let mut cctx = CCtx::new();
-    // Set format version (required by OpenZL). Use latest version (21).
-    cctx.set_parameter(sys::ZL_CParam::ZL_CParam_formatVersion, 21)?;
-
-    // Create a Compressor with ZSTD graph
-    let mut compressor = Compressor::new();
-    compressor.set_parameter(sys::ZL_CParam::ZL_CParam_formatVersion, 21)?;
-
-    let r = unsafe {
-        sys::ZL_Compressor_initUsingGraphFn(compressor.as_mut_ptr(), Some(zstd_graph_callback))
-    };
-    if sys::report_is_error(r) {
-        return Err(report_to_error(r));
-    }
-
-    cctx.ref_compressor(&compressor)?;
-
-    // Estimate capacity (conservative)
-    let cap = 1024 * 1024; // 1MB default
+    let compressor = pool::standard_compressor(graphs::ZSTD)?;
+    let cap = inputs.iter().map(|tr| compress_bound(tr.byte_size())).sum();
     let mut dst = vec![0u8; cap];
-
-    let n = cctx.compress_multi_typed_ref(inputs, &mut dst)?;
+    let n = pool::with_cctx(|cctx| cctx.compress_multi_typed_into(&compressor, inputs, &mut dst))?;
     dst.truncate(n);
     Ok(dst)
 }
 
-pub fn decompress_serial(src: &[u8]) -> Result<Vec<u8>, Error> {
-    // Query decompressed size first
-    let rsize = unsafe { sys::ZL_getDecompressedSize(src.as_ptr() as *const _, src.len()) };
-    if sys::report_is_error(rsize) {
-        let code = sys::report_code(rsize);
-        let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
-            .to_string_lossy()
-            .into_owned();
-        return Err(error_from_report_with_ctx(code, name, None));
-    }
-    let mut dst = vec![0u8; sys::report_value(rsize) as usize];
-    let r = unsafe { sys::ZL_decompress(dst.as_mut_ptr() as *mut _, dst.len(), src.as_ptr() as *const _, src.len()) };
-    if sys::report_is_error(r) {
-        let code = sys::report_code(r);
-        let name = unsafe { CStr::from_ptr(sys::openzl_error_code_to_string(code)) }
-            .to_string_lossy()
-            .into_owned();
-        // No context without DCtx; use empty
-        return Err(error_from_report_with_ctx(code, name, None));
-    }
-    let n = sys::report_value(r) as usize;
+/// Compress one TypedRef with a pooled CCtx
+fn compress_typed_with(compressor: &Compressor, input: &TypedRef) -> Result<Vec<u8>, Error> {
+    let mut dst = vec![0u8; compress_bound(input.byte_size())];
+    let n = pool::with_cctx(|cctx| cctx.compress_typed_into(compressor, input, &mut dst))?;
     dst.truncate(n);
     Ok(dst)
 }
 
+pub fn decompress_serial(src: &[u8]) -> Result<Vec<u8>, Error> {
+    pool::with_dctx(|dctx| {
+        let mut dst = Vec::new();
+        dctx.decompress_append(src, &mut dst)?;
+        Ok(dst)
+    })
+}
+
 /// Decompress compressed data into a TypedBuffer (auto-allocates and determines type)
 pub fn decompress_typed_buffer(compressed: &[u8]) -> Result<TypedBuffer, Error> {
-    let mut dctx = DCtx::new();
     let mut output = TypedBuffer::new();
-    dctx.decompress_typed_buffer(compressed, &mut output)?;
+    pool::with_dctx(|dctx| dctx.decompress_typed_buffer(compressed, &mut output))?;
     Ok(output)
 }
 
@@ -983,44 +1503,10 @@ pub fn decompress_typed_buffer(compressed: &[u8]) -> Result<TypedBuffer, Error>
 /// let data: Vec<u32> = (0..10000).collect();
 /// let compressed = compress_numeric(&data).expect("compression failed");
 /// ```
-pub fn compress_numeric<T: Copy>(data: &[T]) -> Result<Vec<u8>, Error> {
-    // Validate that T is a supported numeric type (1, 2, 4, or 8 bytes)
-    let width = std::mem::size_of::<T>();
-    if !matches!(width, 1 | 2 | 4 | 8) {
-        return Err(Error::Report {
-            code: -1,
-            name: "Invalid numeric type".into(),
-            context: format!("\nElement size must be 1, 2, 4, or 8 bytes, got {width}"),
-        });
-    }
-
-    // Create TypedRef for numeric data
+pub fn compress_numeric<T: Numeric>(data: &[T]) -> Result<Vec<u8>, Error> {
     let tref = TypedRef::numeric(data)?;
-
-    // Create CCtx and Compressor with NUMERIC graph
-    let mut cctx = CCtx::new();
-    cctx.set_parameter(sys::ZL_CParam::ZL_CParam_formatVersion, 21)?;
-
-    let mut compressor = Compressor::new();
-    compressor.set_parameter(sys::ZL_CParam::ZL_CParam_formatVersion, 21)?;
-
-    // Initialize with NUMERIC graph
-    let r = unsafe {
-        sys::ZL_Compressor_initUsingGraphFn(compressor.as_mut_ptr(), Some(numeric_graph_callback))
-    };
-    if sys::report_is_error(r) {
-        return Err(report_to_error(r));
-    }
-
-    cctx.ref_compressor(&compressor)?;
-
-    // Compress
-    let cap = compress_bound(data.len() * width);
-    let mut dst = vec![0u8; cap];
-
-    let n = cctx.compress_typed_ref(&tref, &mut dst)?;
-    dst.truncate(n);
-    Ok(dst)
+    let compressor = pool::standard_compressor(graphs::NUMERIC)?;
+    compress_typed_with(&compressor, &tref)
 }
 
 /// Decompress numeric data that was compressed with `compress_numeric`.
@@ -1035,47 +1521,19 @@ pub fn compress_numeric<T: Copy>(data: &[T]) -> Result<Vec<u8>, Error> {
 /// let decompressed: Vec<u32> = decompress_numeric(&compressed).expect("decompression failed");
 /// assert_eq!(data, decompressed);
 /// ```
-pub fn decompress_numeric<T: Copy>(compressed: &[u8]) -> Result<Vec<T>, Error> {
+pub fn decompress_numeric<T: Numeric>(compressed: &[u8]) -> Result<Vec<T>, Error> {
     let width = std::mem::size_of::<T>();
-    if !matches!(width, 1 | 2 | 4 | 8) {
-        return Err(Error::Report {
-            code: -1,
-            name: "Invalid numeric type".into(),
-            context: format!("\nElement size must be 1, 2, 4, or 8 bytes, got {width}"),
-        });
-    }
-
-    // Decompress into TypedBuffer
-    let tbuf = decompress_typed_buffer(compressed)?;
-
-    // Verify it's numeric type
-    if tbuf.data_type() != sys::ZL_Type::ZL_Type_numeric {
-        return Err(Error::Report {
-            code: -1,
-            name: "Type mismatch".into(),
-            context: format!("\nExpected numeric type, got {:?}", tbuf.data_type()),
-        });
-    }
 
-    // Verify element width matches T
-    if tbuf.elt_width() != width {
-        return Err(Error::Report {
-            code: -1,
-            name: "Width mismatch".into(),
-            context: format!(
-                "\nExpected element width {}, got {}",
-                width,
-                tbuf.elt_width()
-            ),
-        });
+    let rsize = unsafe { sys::ZL_getDecompressedSize(compressed.as_ptr() as *const _, compressed.len()) };
+    if sys::report_is_error(rsize) {
+        return Err(report_to_error(rsize));
     }
-
-    // Extract numeric data
-    let slice = tbuf.as_numeric::<T>().ok_or_else(|| Error::Report {
-        code: -1,
-        name: "Failed to extract numeric data".into(),
-        context: "\nAlignment or type mismatch".into(),
-    })?;
-
-    Ok(slice.to_vec())
+    let capacity = sys::report_value(rsize) / width;
+
+    // Decompress straight into the Vec, skipping the TypedBuffer copy
+    let mut out: Vec<T> = Vec::with_capacity(capacity);
+    let n = pool::with_dctx(|dctx| dctx.decompress_numeric_raw(compressed, out.as_mut_ptr(), capacity))?;
+    // SAFETY: the first `n` elements were written by the decompressor
+    unsafe { out.set_len(n) };
+    Ok(out)
 }
@@ -4,6 +4,7 @@ use rust_openzl::{
     compress_serial, decompress_serial,
     compress_typed_ref, decompress_typed_buffer,
     compress_with_graph, compress_numeric, decompress_numeric,
+    compress_with_compressor, graphs, pool, CCtx, Compressor, CompressorSnapshot, DCtx,
     TypedRef, ZstdGraph, NumericGraph, StoreGraph,
 };
 
@@ -211,3 +212,182 @@ fn compress_numeric_f64_roundtrip() {
     let decompressed: Vec<f64> = decompress_numeric(&compressed).expect("decompress numeric f64");
     assert_eq!(data, decompressed);
 }
+
+// Long-lived contexts and Compressors
+
+#[test]
+fn reused_contexts_roundtrip() {
+    let compressor = Compressor::with_graph(&ZstdGraph).expect("build compressor");
+    let mut cctx = CCtx::new();
+    let mut dctx = DCtx::new();
+    let (mut compressed, mut decompressed) = (Vec::new(), Vec::new());
+    for i in 0..100 {
+        let msg = format!("{{\"id\":{i},\"name\":\"user{i}\",\"active\":true}}");
+        compressed.clear();
+        cctx.compress_append(&compressor, msg.as_bytes(), &mut compressed).expect("compress");
+        decompressed.clear();
+        dctx.decompress_append(&compressed, &mut decompressed).expect("decompress");
+        assert_eq!(msg.as_bytes(), decompressed.as_slice());
+    }
+}
+
+#[test]
+fn compress_into_caller_buffers() {
+    let compressor = Compressor::with_graph(&ZstdGraph).expect("build compressor");
+    let src = b"caller-provided buffers, caller-provided buffers".repeat(10);
+    let mut cctx = CCtx::new();
+    let mut dst = vec![0u8; 4096];
+    let n = cctx.compress_into(&compressor, &src, &mut dst).expect("compress_into");
+
+    let mut dctx = DCtx::new();
+    let mut out = vec![0u8; src.len()];
+    let m = dctx.decompress_into(&dst[..n], &mut out).expect("decompress_into");
+    assert_eq!(src.as_slice(), &out[..m]);
+
+    // Too small a destination is an error, not a truncation
+    let mut tiny = [0u8; 4];
+    assert!(cctx.compress_into(&compressor, &src, &mut tiny).is_err());
+    // ... and the CCtx remains usable
+    let n2 = cctx.compress_into(&compressor, &src, &mut dst).expect("compress after error");
+    assert_eq!(n, n2);
+}
+
+#[test]
+fn decompress_numeric_into_caller_buffer() {
+    let data: Vec<u32> = (0..1000).map(|i| i * 3).collect();
+    let compressed = compress_numeric(&data).expect("compress numeric");
+
+    let mut dctx = DCtx::new();
+    let mut out = vec![0u32; data.len()];
+    let n = dctx.decompress_numeric_into(&compressed, &mut out).expect("decompress into");
+    assert_eq!(n, data.len());
+    assert_eq!(data, out);
+
+    // Untyped destination: u64 storage keeps it aligned for any numeric width
+    let mut storage = vec![0u64; data.len() / 2];
+    let bytes = unsafe {
+        std::slice::from_raw_parts_mut(storage.as_mut_ptr() as *mut u8, storage.len() * 8)
+    };
+    let info = dctx.decompress_typed_into(&compressed, bytes).expect("decompress typed into");
+    assert_eq!(info.elt_width, 4);
+    assert_eq!(info.num_elts, data.len());
+
+    // Element width is checked
+    let mut wrong = vec![0u16; data.len() * 2];
+    assert!(dctx.decompress_numeric_into(&compressed, &mut wrong).is_err());
+
+    // Non-numeric frames are rejected before anything is written
+    let serial = compress_serial(b"not numbers").expect("compress serial");
+    let mut untouched = vec![7u32; 8];
+    assert!(dctx.decompress_numeric_into(&serial, &mut untouched).is_err());
+    assert!(untouched.iter().all(|&v| v == 7));
+}
+
+#[test]
+fn sticky_parameters_dont_keep_the_compressor() {
+    let src = b"sticky parameters ".repeat(100);
+    let mut cctx = CCtx::new();
+    cctx.set_parameter(rust_openzl_sys::ZL_CParam::ZL_CParam_stickyParameters, 1)
+        .expect("set sticky");
+    let mut dst = vec![0u8; 4096];
+    {
+        let compressor = Compressor::with_graph(&graphs::ZSTD).expect("build compressor");
+        cctx.ref_compressor(&compressor).expect("ref compressor");
+        let n = cctx.compress_typed_ref(&TypedRef::serial(&src), &mut dst).expect("compress");
+        assert_eq!(src, decompress_serial(&dst[..n]).expect("decompress"));
+    }
+    // The dropped Compressor is no longer referenced
+    assert!(cctx.compress_typed_ref(&TypedRef::serial(&src), &mut dst).is_err());
+}
+
+#[test]
+fn custom_graph_is_used() {
+    let src = b"Repeated data for a custom graph. ".repeat(200);
+
+    // A Store graph must not compress: this failed when graphs fell back to zstd
+    let stored = compress_with_graph(&src, &StoreGraph).expect("store");
+    assert!(stored.len() >= src.len());
+
+    let zstd19 = |c: &mut Compressor| c.register_zstd_graph_with_level(19);
+    let compressed = compress_with_graph(&src, &zstd19).expect("zstd level 19");
+    assert!(compressed.len() < src.len() / 10);
+    assert_eq!(src, decompress_serial(&compressed).expect("decompress"));
+}
+
+#[test]
+fn shared_compressor_and_pool() {
+    let compressor = Compressor::with_graph(&graphs::ZSTD).expect("build compressor");
+    let src = b"pooled contexts".repeat(50);
+    for _ in 0..3 {
+        let compressed = compress_with_compressor(&src, &compressor).expect("compress");
+        assert_eq!(src, decompress_serial(&compressed).expect("decompress"));
+    }
+
+    // Nested pool use falls back to a temporary context
+    let compressed = pool::with_cctx(|_| compress_serial(&src)).expect("nested compress");
+    assert_eq!(src, decompress_serial(&compressed).expect("decompress"));
+
+    pool::clear();
+    assert_eq!(src, decompress_serial(&compress_serial(&src).unwrap()).unwrap());
+}
+
+#[test]
+fn deserialize_rejects_garbage() {
+    assert!(Compressor::deserialize(b"not a compressor").is_err());
+}
+
+#[test]
+fn compiled_compressor_roundtrip() {
+    let mut original = Compressor::with_graph(&graphs::ZSTD).expect("build compressor");
+    let zstd = original.register_zstd_graph_with_level(9);
+    original.select_starting_graph(zstd).expect("select graph");
+    let compiled = Compressor::compile(&original.serialize().expect("serialize")).expect("compile");
+    let loaded = Compressor::load_compiled(&compiled).expect("load");
+
+    let src = b"compiled compressors load fast ".repeat(100);
+    let expected = compress_with_compressor(&src, &original).expect("compress");
+    assert_eq!(expected, compress_with_compressor(&src, &loaded).expect("compress"));
+
+    assert!(Compressor::load_compiled(&compiled[..compiled.len() - 1]).is_err());
+    assert!(Compressor::load_compiled(b"not a compiled compressor").is_err());
+}
+
+#[test]
+fn snapshot_shared_across_threads() {
+    let compiled = Compressor::compile(
+        &Compressor::with_graph(&graphs::ZSTD).unwrap().serialize().unwrap(),
+    )
+    .expect("compile");
+    let snapshot = CompressorSnapshot::load_compiled(&compiled).expect("snapshot");
+    let src = b"shared snapshot ".repeat(200);
+    let workers: Vec<_> = (0..4)
+        .map(|_| {
+            let (snapshot, src) = (snapshot.clone(), src.clone());
+            std::thread::spawn(move || {
+                let mut cctx = CCtx::new();
+                let mut compressed = Vec::new();
+                cctx.compress_append(&snapshot, &src, &mut compressed).unwrap();
+                compressed
+            })
+        })
+        .collect();
+    drop(snapshot);
+    for worker in workers {
+        assert_eq!(src, decompress_serial(&worker.join().unwrap()).expect("decompress"));
+    }
+
+    assert!(CompressorSnapshot::new(Compressor::new()).is_err());
+}
+
+#[test]
+fn cctx_holds_referenced_snapshot() {
+    let snapshot = CompressorSnapshot::new(Compressor::with_graph(&graphs::ZSTD).unwrap())
+        .expect("snapshot");
+    let src = b"referenced snapshot ".repeat(100);
+    let mut cctx = CCtx::new();
+    cctx.ref_snapshot(&snapshot).expect("ref snapshot");
+    drop(snapshot);
+    let mut dst = vec![0u8; 4096];
+    let n = cctx.compress_typed_ref(&TypedRef::serial(&src), &mut dst).expect("compress");
+    assert_eq!(src, decompress_serial(&dst[..n]).expect("decompress"));
+}